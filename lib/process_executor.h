@@ -0,0 +1,420 @@
+#pragma once
+
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "scheduler.h"
+
+// Runs the tasks of a TaskScheduler in forked worker processes.
+// The graph is split into one partition per worker, keeping dependent tasks
+// together where possible. Results are sent back to the parent over Unix
+// sockets and forwarded to other workers only for cross-partition edges.
+// If a worker dies, it is restarted and only the task it was running is re-run.
+//
+// Every pending task must have a result type accepted by ResultSerializer.
+// Side effects of tasks (e.g. modified std::ref arguments) stay in the worker.
+class ProcessExecutor {
+public:
+    using TaskId = TaskScheduler::TaskId;
+    using TaskSchedulerError = TaskScheduler::TaskSchedulerError;
+
+    ProcessExecutor(TaskScheduler& scheduler, size_t worker_count, size_t max_retries = 3)
+        : scheduler_(scheduler), workers_(worker_count), max_retries_(max_retries) {
+        if (worker_count == 0) {
+            throw TaskSchedulerError("Worker count must be positive");
+        }
+    }
+
+    ~ProcessExecutor() noexcept {
+        stopWorkers();
+    }
+
+    ProcessExecutor(const ProcessExecutor&) = delete;
+    ProcessExecutor& operator=(const ProcessExecutor&) = delete;
+
+    size_t partitionOf(TaskId id) {
+        updatePartitions();
+        auto it = partition_.find(id);
+        if (it == partition_.end()) {
+            throw TaskSchedulerError("Task not found");
+        }
+        return it->second;
+    }
+
+    size_t crossPartitionEdges() {
+        updatePartitions();
+        size_t edges = 0;
+        for (const auto& [id, deps] : scheduler_.dependency_graph_) {
+            for (TaskId dep : deps) {
+                if (partition_[dep] != partition_[id]) {
+                    edges++;
+                }
+            }
+        }
+        return edges;
+    }
+
+    // Number of workers restarted after dying during the last executeAll
+    size_t restartCount() const noexcept { return restarts_; }
+
+    void executeAll() {
+        updatePartitions();
+        restarts_ = 0;
+        completed_.clear();
+        attempts_.clear();
+
+        std::unordered_set<TaskId> pending;
+        for (const auto& [id, task] : scheduler_.tasks_) {
+            if (!task->isExecuted()) {
+                if (!task->isSerializable()) {
+                    throw TaskSchedulerError("Result type is not serializable");
+                }
+                pending.insert(id);
+            }
+        }
+
+        std::unordered_map<TaskId, size_t> waiting;
+        std::unordered_map<TaskId, std::vector<TaskId>> dependents;
+        std::vector<std::deque<TaskId>> ready(workers_.size());
+        for (TaskId id : pending) {
+            waiting[id] = 0;
+            for (TaskId dep : scheduler_.dependency_graph_[id]) {
+                if (pending.count(dep)) {
+                    waiting[id]++;
+                    dependents[dep].push_back(id);
+                }
+            }
+            if (waiting[id] == 0) {
+                ready[partition_[id]].push_back(id);
+            }
+        }
+
+        try {
+            while (completed_.size() < pending.size()) {
+                std::vector<pollfd> fds;
+                std::vector<size_t> polled;
+                for (size_t w = 0; w < workers_.size(); ++w) {
+                    Worker& worker = workers_[w];
+                    while (!worker.busy && !ready[w].empty()) {
+                        TaskId id = ready[w].front();
+                        ready[w].pop_front();
+                        dispatch(w, id, ready[w]);
+                    }
+                    if (worker.busy) {
+                        fds.push_back({worker.fd, POLLIN, 0});
+                        polled.push_back(w);
+                    }
+                }
+
+                if (fds.empty()) {
+                    throw TaskSchedulerError("Cycle detected during execution");
+                }
+                if (poll(fds.data(), fds.size(), -1) < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw TaskSchedulerError("Failed to poll worker processes");
+                }
+
+                for (size_t i = 0; i < fds.size(); ++i) {
+                    if (fds[i].revents == 0) {
+                        continue;
+                    }
+                    size_t w = polled[i];
+                    Worker& worker = workers_[w];
+
+                    MessageType type;
+                    TaskId id;
+                    std::vector<char> payload;
+                    if (!readMessage(worker.fd, type, id, payload)) {
+                        handleWorkerDeath(w, ready[w]);
+                        continue;
+                    }
+                    if (id != worker.current) {
+                        throw TaskSchedulerError("Unexpected reply from worker process");
+                    }
+                    if (type == MessageType::Failed) {
+                        throw TaskSchedulerError("Task failed in worker process");
+                    }
+                    if (type != MessageType::Done) {
+                        throw TaskSchedulerError("Unexpected reply from worker process");
+                    }
+
+                    scheduler_.tasks_[id]->loadResult(payload.data(), payload.size());
+                    completed_.insert(id);
+                    worker.known.insert(id);
+                    worker.busy = false;
+                    worker.running = false;
+                    for (TaskId dependent : dependents[id]) {
+                        if (--waiting[dependent] == 0) {
+                            ready[partition_[dependent]].push_back(dependent);
+                        }
+                    }
+                }
+            }
+        } catch (...) {
+            stopWorkers();
+            throw;
+        }
+
+        stopWorkers();
+    }
+
+private:
+    enum class MessageType : uint8_t { Run, Result, Done, Failed, Exit };
+
+    struct MessageHeader {
+        MessageType type;
+        TaskId id;
+        uint64_t size;
+    };
+
+    struct Worker {
+        pid_t pid = -1;
+        int fd = -1;
+        bool busy = false;
+        bool running = false;  // Run message for current was sent
+        TaskId current = 0;
+        std::unordered_set<TaskId> known;  // results this worker already holds
+    };
+
+    // Greedy streaming partitioning: task ids are already in topological
+    // order, so each task joins the partition holding most of its
+    // dependencies, unless that partition is full. Only pending tasks count
+    // towards capacity; executed ones keep a partition for edge counting.
+    void updatePartitions() {
+        partition_.clear();
+        size_t pending = 0;
+        for (const auto& [id, task] : scheduler_.tasks_) {
+            if (!task->isExecuted()) {
+                pending++;
+            }
+        }
+        std::vector<size_t> load(workers_.size(), 0);
+        size_t capacity = (pending + workers_.size() - 1) / workers_.size();
+
+        for (TaskId id = 0; id < scheduler_.nextId_; ++id) {
+            std::vector<size_t> shared(workers_.size(), 0);
+            for (TaskId dep : scheduler_.dependency_graph_[id]) {
+                shared[partition_[dep]]++;
+            }
+
+            size_t best = 0;
+            for (size_t w = 1; w < workers_.size(); ++w) {
+                bool best_full = load[best] >= capacity;
+                bool full = load[w] >= capacity;
+                if (best_full != full) {
+                    if (best_full) {
+                        best = w;
+                    }
+                } else if (shared[w] != shared[best]) {
+                    if (shared[w] > shared[best]) {
+                        best = w;
+                    }
+                } else if (load[w] < load[best]) {
+                    best = w;
+                }
+            }
+            partition_[id] = best;
+            if (!scheduler_.tasks_[id]->isExecuted()) {
+                load[best]++;
+            }
+        }
+    }
+
+    void dispatch(size_t w, TaskId id, std::deque<TaskId>& ready) {
+        Worker& worker = workers_[w];
+        if (worker.pid < 0) {
+            spawnWorker(w);
+        }
+        worker.busy = true;
+        worker.current = id;
+
+        std::vector<char> payload;
+        for (TaskId dep : scheduler_.dependency_graph_[id]) {
+            if (!completed_.count(dep) || worker.known.count(dep)) {
+                continue;
+            }
+            payload.clear();
+            scheduler_.tasks_[dep]->serializeResult(payload);
+            if (!writeMessage(worker.fd, MessageType::Result, dep, payload)) {
+                handleWorkerDeath(w, ready);
+                return;
+            }
+            worker.known.insert(dep);
+        }
+
+        payload.clear();
+        if (!writeMessage(worker.fd, MessageType::Run, id, payload)) {
+            handleWorkerDeath(w, ready);
+            return;
+        }
+        worker.running = true;
+    }
+
+    void spawnWorker(size_t w) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+            throw TaskSchedulerError("Failed to create worker socket");
+        }
+        std::fflush(nullptr);
+
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            throw TaskSchedulerError("Failed to fork worker process");
+        }
+        if (pid == 0) {
+            close(fds[0]);
+            for (const Worker& other : workers_) {
+                if (other.fd >= 0) {
+                    close(other.fd);
+                }
+            }
+            runWorker(fds[1]);
+        }
+
+        close(fds[1]);
+        Worker& worker = workers_[w];
+        worker.pid = pid;
+        worker.fd = fds[0];
+        worker.busy = false;
+        worker.known = completed_;
+    }
+
+    // Worker process loop. The worker is a copy of the parent, so it already
+    // holds every task and every result completed before it was forked.
+    [[noreturn]] void runWorker(int fd) noexcept {
+        MessageType type;
+        TaskId id;
+        std::vector<char> payload;
+        try {
+            while (readMessage(fd, type, id, payload) && type != MessageType::Exit) {
+                auto& task = scheduler_.tasks_[id];
+                if (type == MessageType::Result) {
+                    task->loadResult(payload.data(), payload.size());
+                    continue;
+                }
+
+                MessageType reply = MessageType::Done;
+                payload.clear();
+                try {
+                    task->execute();
+                    task->serializeResult(payload);
+                } catch (...) {
+                    reply = MessageType::Failed;
+                    payload.clear();
+                }
+                if (!writeMessage(fd, reply, id, payload)) {
+                    break;
+                }
+            }
+        } catch (...) {
+        }
+        std::fflush(nullptr);
+        _exit(0);
+    }
+
+    void handleWorkerDeath(size_t w, std::deque<TaskId>& ready) {
+        Worker& worker = workers_[w];
+        close(worker.fd);
+        waitpid(worker.pid, nullptr, 0);
+        worker.fd = -1;
+        worker.pid = -1;
+        restarts_++;
+
+        if (worker.busy) {
+            // A worker that died before receiving Run did not crash on the task
+            if (worker.running && ++attempts_[worker.current] > max_retries_) {
+                throw TaskSchedulerError("Task keeps crashing worker processes");
+            }
+            worker.busy = false;
+            worker.running = false;
+            ready.push_front(worker.current);
+        }
+    }
+
+    void stopWorkers() noexcept {
+        for (Worker& worker : workers_) {
+            if (worker.pid < 0) {
+                continue;
+            }
+            if (worker.busy) {
+                kill(worker.pid, SIGKILL);
+            } else {
+                writeMessage(worker.fd, MessageType::Exit, 0, {});
+            }
+            close(worker.fd);
+            waitpid(worker.pid, nullptr, 0);
+            worker = Worker{};
+        }
+    }
+
+    static bool readAll(int fd, void* data, size_t size) {
+        char* ptr = static_cast<char*>(data);
+        while (size > 0) {
+            ssize_t n = recv(fd, ptr, size, 0);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            ptr += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    static bool writeAll(int fd, const void* data, size_t size) {
+        const char* ptr = static_cast<const char*>(data);
+        while (size > 0) {
+            ssize_t n = send(fd, ptr, size, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            ptr += n;
+            size -= n;
+        }
+        return true;
+    }
+
+    static bool readMessage(int fd, MessageType& type, TaskId& id, std::vector<char>& payload) {
+        MessageHeader header;
+        if (!readAll(fd, &header, sizeof(header))) {
+            return false;
+        }
+        type = header.type;
+        id = header.id;
+        payload.resize(header.size);
+        return readAll(fd, payload.data(), payload.size());
+    }
+
+    static bool writeMessage(int fd, MessageType type, TaskId id, const std::vector<char>& payload) {
+        MessageHeader header{type, id, payload.size()};
+        return writeAll(fd, &header, sizeof(header)) && writeAll(fd, payload.data(), payload.size());
+    }
+
+    TaskScheduler& scheduler_;
+    std::vector<Worker> workers_;
+    size_t max_retries_;
+    size_t restarts_ = 0;
+    std::unordered_map<TaskId, size_t> partition_;
+    std::unordered_set<TaskId> completed_;
+    std::unordered_map<TaskId, size_t> attempts_;
+};
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <concepts>
+#include <cstring>
 #include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <queue>
+#include <vector>
 
 template<typename T> struct removeReference { using type = T; };
 template<typename T> struct removeReference<T&> { using type = T; };
@@ -19,6 +26,29 @@ constexpr T&& myForward(typename removeReference<T>::type& t) noexcept {
     return static_cast<T&&>(t);
 }
 
+// Converts task results to bytes and back so they can cross process boundaries
+// (see ProcessExecutor). Specialize it for your own result types.
+template<typename T, typename Enable = void>
+struct ResultSerializer {};
+
+template<typename T> struct isView { static constexpr bool value = false; };
+template<typename C, typename Traits> struct isView<std::basic_string_view<C, Traits>> { static constexpr bool value = true; };
+template<typename T, size_t Extent> struct isView<std::span<T, Extent>> { static constexpr bool value = true; };
+
+// Trivially copyable types that are copied byte by byte. Pointers and views
+// are excluded, since they would point into the memory of another process.
+template<typename T>
+constexpr bool isPlainResult = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> &&
+                               !std::is_member_pointer_v<T> && !isView<T>::value;
+
+template<typename T>
+concept SerializableResult = requires(const T& value, std::vector<char>& out, const char* data, size_t size) {
+    ResultSerializer<T>::serialize(value, out);
+    { ResultSerializer<T>::deserialize(data, size) } -> std::same_as<T>;
+};
+
+class ProcessExecutor;
+
 class TaskScheduler {
 public:
     class TaskSchedulerError {
@@ -161,11 +191,16 @@ public:
     }
 
 private:
+    friend class ProcessExecutor;
+
     struct ITask {
         virtual ~ITask() noexcept = default;
         virtual void execute() = 0;
         virtual bool isExecuted() const noexcept = 0;
         virtual void getDependencies(std::unordered_set<TaskId>& deps) const = 0;
+        virtual bool isSerializable() const noexcept = 0;
+        virtual void serializeResult(std::vector<char>& out) const = 0;
+        virtual void loadResult(const char* data, size_t size) = 0;
     };
 
     template<typename T>
@@ -201,6 +236,31 @@ private:
             getDependenciesFromTuple(deps, args_);
         }
 
+        bool isSerializable() const noexcept override {
+            return SerializableResult<ResultType>;
+        }
+
+        void serializeResult(std::vector<char>& out) const override {
+            if constexpr (SerializableResult<ResultType>) {
+                if (!executed_) {
+                    throw TaskSchedulerError("Task not executed");
+                }
+                ResultSerializer<ResultType>::serialize(result_, out);
+            } else {
+                throw TaskSchedulerError("Result type is not serializable");
+            }
+        }
+
+        // Stores a result computed elsewhere, so the task is not run here
+        void loadResult(const char* data, size_t size) override {
+            if constexpr (SerializableResult<ResultType>) {
+                result_ = ResultSerializer<ResultType>::deserialize(data, size);
+                executed_ = true;
+            } else {
+                throw TaskSchedulerError("Result type is not serializable");
+            }
+        }
+
     private:
         template<typename Tuple, size_t... Is>
         void getDependenciesFromTupleHelper(std::unordered_set<TaskId>& deps, const Tuple& tuple, std::index_sequence<Is...>) const {
@@ -266,4 +326,52 @@ private:
     std::unordered_map<TaskId, std::unordered_set<TaskId>> dependency_graph_;
     std::unordered_map<TaskId, std::unordered_set<TaskId>> reverse_dependency_graph_;
     TaskId nextId_ = 0;
-};
\ No newline at end of file
+};
+
+template<typename T>
+struct ResultSerializer<T, std::enable_if_t<isPlainResult<T>>> {
+    static void serialize(const T& value, std::vector<char>& out) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    static T deserialize(const char* data, size_t size) {
+        if (size != sizeof(T)) {
+            throw TaskScheduler::TaskSchedulerError("Serialized result has wrong size");
+        }
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+};
+
+template<>
+struct ResultSerializer<std::string> {
+    static void serialize(const std::string& value, std::vector<char>& out) {
+        out.insert(out.end(), value.begin(), value.end());
+    }
+
+    static std::string deserialize(const char* data, size_t size) {
+        return std::string(data, size);
+    }
+};
+
+// std::vector<bool> is excluded: it is bit-packed and has no data()
+template<typename T>
+struct ResultSerializer<std::vector<T>, std::enable_if_t<isPlainResult<T> && !std::is_same_v<T, bool>>> {
+    static void serialize(const std::vector<T>& value, std::vector<char>& out) {
+        const char* bytes = reinterpret_cast<const char*>(value.data());
+        out.insert(out.end(), bytes, bytes + value.size() * sizeof(T));
+    }
+
+    static std::vector<T> deserialize(const char* data, size_t size) {
+        if (size % sizeof(T) != 0) {
+            throw TaskScheduler::TaskSchedulerError("Serialized result has wrong size");
+        }
+        std::vector<T> value(size / sizeof(T));
+        if (!value.empty()) {
+            std::memcpy(value.data(), data, size);
+        }
+        return value;
+    }
+};
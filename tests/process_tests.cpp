@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include "process_executor.h"
+#include <cmath>
+#include <stdexcept>
+#include <span>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+
+struct Point {
+    std::string name;
+    int x;
+};
+
+template<>
+struct ResultSerializer<Point> {
+    static void serialize(const Point& value, std::vector<char>& out) {
+        ResultSerializer<int>::serialize(value.x, out);
+        out.insert(out.end(), value.name.begin(), value.name.end());
+    }
+
+    static Point deserialize(const char* data, size_t size) {
+        return Point{std::string(data + sizeof(int), size - sizeof(int)),
+                     ResultSerializer<int>::deserialize(data, sizeof(int))};
+    }
+};
+
+// Counters shared between the test and forked workers
+static int* sharedCounters(size_t count) {
+    void* memory = mmap(nullptr, count * sizeof(int), PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        throw std::runtime_error("Failed to map shared counters");
+    }
+    return static_cast<int*>(memory);
+}
+
+// Test quadratic equation calculation in worker processes
+TEST(ProcessExecutorTest, QuadraticEquation) {
+    TaskScheduler scheduler;
+    float a = 1, b = -2, c = 0;
+
+    auto id1 = scheduler.add([](float a, float c) { return -4 * a * c; }, a, c);
+    auto id2 = scheduler.add([](float b, float v) { return b * b + v; }, b, scheduler.getFutureResult<float>(id1));
+    auto id3 = scheduler.add([](float b, float d) { return -b + std::sqrt(d); }, b, scheduler.getFutureResult<float>(id2));
+    auto id4 = scheduler.add([](float b, float d) { return -b - std::sqrt(d); }, b, scheduler.getFutureResult<float>(id2));
+    auto id5 = scheduler.add([](float a, float v) { return v / (2 * a); }, a, scheduler.getFutureResult<float>(id3));
+    auto id6 = scheduler.add([](float a, float v) { return v / (2 * a); }, a, scheduler.getFutureResult<float>(id4));
+
+    ProcessExecutor executor(scheduler, 2);
+    executor.executeAll();
+
+    EXPECT_FLOAT_EQ(scheduler.getResult<float>(id5), 2.0f);
+    EXPECT_FLOAT_EQ(scheduler.getResult<float>(id6), 0.0f);
+}
+
+// Test that tasks really run outside the calling process
+TEST(ProcessExecutorTest, RunsInWorkerProcess) {
+    TaskScheduler scheduler;
+    auto id = scheduler.add([] { return static_cast<int>(getpid()); });
+
+    ProcessExecutor executor(scheduler, 1);
+    executor.executeAll();
+
+    EXPECT_NE(scheduler.getResult<int>(id), static_cast<int>(getpid()));
+}
+
+// Test independent chains are kept in separate partitions
+TEST(ProcessExecutorTest, PartitionKeepsChainsTogether) {
+    TaskScheduler scheduler;
+    auto a1 = scheduler.add([] { return 1; });
+    auto a2 = scheduler.add([](int x) { return x + 1; }, scheduler.getFutureResult<int>(a1));
+    auto a3 = scheduler.add([](int x) { return x + 1; }, scheduler.getFutureResult<int>(a2));
+    auto b1 = scheduler.add([] { return 10; });
+    auto b2 = scheduler.add([](int x) { return x + 1; }, scheduler.getFutureResult<int>(b1));
+    auto b3 = scheduler.add([](int x) { return x + 1; }, scheduler.getFutureResult<int>(b2));
+
+    ProcessExecutor executor(scheduler, 2);
+
+    EXPECT_EQ(executor.partitionOf(a1), executor.partitionOf(a3));
+    EXPECT_EQ(executor.partitionOf(b1), executor.partitionOf(b3));
+    EXPECT_NE(executor.partitionOf(a1), executor.partitionOf(b1));
+    EXPECT_EQ(executor.crossPartitionEdges(), 0u);
+
+    executor.executeAll();
+    EXPECT_EQ(scheduler.getResult<int>(a3), 3);
+    EXPECT_EQ(scheduler.getResult<int>(b3), 12);
+}
+
+// Test results crossing partitions, including strings and user types
+TEST(ProcessExecutorTest, CrossPartitionResults) {
+    TaskScheduler scheduler;
+    auto id1 = scheduler.add([] { return std::string("left"); });
+    auto id2 = scheduler.add([] { return 7; });
+    auto id3 = scheduler.add([](const std::string& name, int x) { return Point{name, x}; },
+                             scheduler.getFutureResult<std::string>(id1),
+                             scheduler.getFutureResult<int>(id2));
+
+    ProcessExecutor executor(scheduler, 2);
+    EXPECT_NE(executor.partitionOf(id1), executor.partitionOf(id2));
+    executor.executeAll();
+
+    Point point = scheduler.getResult<Point>(id3);
+    EXPECT_EQ(point.name, "left");
+    EXPECT_EQ(point.x, 7);
+}
+
+// Test that a dead worker is restarted and only its lost task is re-run
+TEST(ProcessExecutorTest, WorkerDeathRerunsLostTask) {
+    int* runs = sharedCounters(2);
+    TaskScheduler scheduler;
+
+    auto id1 = scheduler.add([runs] { return ++runs[0]; });
+    auto id2 = scheduler.add([runs](int x) {
+        if (++runs[1] == 1) {
+            _exit(1);
+        }
+        return x * 10;
+    }, scheduler.getFutureResult<int>(id1));
+
+    ProcessExecutor executor(scheduler, 1);
+    executor.executeAll();
+
+    EXPECT_EQ(scheduler.getResult<int>(id2), 10);
+    EXPECT_EQ(runs[0], 1);
+    EXPECT_EQ(runs[1], 2);
+    EXPECT_EQ(executor.restartCount(), 1);
+    munmap(runs, 2 * sizeof(int));
+}
+
+// Test that a task crashing every worker is eventually reported
+TEST(ProcessExecutorTest, PersistentCrash) {
+    TaskScheduler scheduler;
+    scheduler.add([]() -> int { _exit(1); });
+
+    ProcessExecutor executor(scheduler, 1, 2);
+    EXPECT_THROW(executor.executeAll(), TaskScheduler::TaskSchedulerError);
+}
+
+// Test exceptions thrown by a task in a worker
+TEST(ProcessExecutorTest, TaskException) {
+    TaskScheduler scheduler;
+    scheduler.add([]() -> int { throw 1; });
+
+    ProcessExecutor executor(scheduler, 2);
+    EXPECT_THROW(executor.executeAll(), TaskScheduler::TaskSchedulerError);
+}
+
+// Test rejection of results without a serializer
+TEST(ProcessExecutorTest, NonSerializableResult) {
+    struct Opaque {
+        std::string value;
+    };
+
+    TaskScheduler scheduler;
+    scheduler.add([] { return Opaque{"data"}; });
+
+    ProcessExecutor executor(scheduler, 2);
+    EXPECT_THROW(executor.executeAll(), TaskScheduler::TaskSchedulerError);
+}
+
+// Test rejection of raw pointer results
+TEST(ProcessExecutorTest, PointerResult) {
+    TaskScheduler scheduler;
+    scheduler.add([] { return static_cast<int*>(nullptr); });
+
+    ProcessExecutor executor(scheduler, 2);
+    EXPECT_THROW(executor.executeAll(), TaskScheduler::TaskSchedulerError);
+}
+
+// Test rejection of view results
+TEST(ProcessExecutorTest, ViewResult) {
+    TaskScheduler scheduler;
+    scheduler.add([] { return std::string_view("text"); });
+    ProcessExecutor executor(scheduler, 2);
+    EXPECT_THROW(executor.executeAll(), TaskScheduler::TaskSchedulerError);
+
+    TaskScheduler span_scheduler;
+    span_scheduler.add([] { return std::span<const int>(); });
+    ProcessExecutor span_executor(span_scheduler, 2);
+    EXPECT_THROW(span_executor.executeAll(), TaskScheduler::TaskSchedulerError);
+}
+
+// Test that executed tasks do not take partition capacity
+TEST(ProcessExecutorTest, PartitionIgnoresExecutedTasks) {
+    TaskScheduler scheduler;
+    auto id = scheduler.add([] { return 1; });
+    for (int i = 0; i < 3; ++i) {
+        id = scheduler.add([](int x) { return x + 1; }, scheduler.getFutureResult<int>(id));
+    }
+    EXPECT_EQ(scheduler.getResult<int>(id), 4);
+
+    std::vector<TaskScheduler::TaskId> pending;
+    for (int i = 0; i < 4; ++i) {
+        pending.push_back(scheduler.add([i] { return i; }));
+    }
+
+    ProcessExecutor executor(scheduler, 2);
+    EXPECT_NE(executor.partitionOf(pending[0]), executor.partitionOf(pending[1]));
+    EXPECT_NE(executor.partitionOf(pending[2]), executor.partitionOf(pending[3]));
+    executor.executeAll();
+    EXPECT_EQ(scheduler.getResult<int>(pending[3]), 3);
+}
+
+// Test rejection of serialized results with a wrong size
+TEST(ProcessExecutorTest, WrongSizeResult) {
+    const char data[3] = {};
+    EXPECT_THROW(ResultSerializer<int>::deserialize(data, sizeof(data)), TaskScheduler::TaskSchedulerError);
+    EXPECT_THROW(ResultSerializer<std::vector<int>>::deserialize(data, sizeof(data)),
+                 TaskScheduler::TaskSchedulerError);
+}
+
+// Test that already computed tasks are not re-run by workers
+TEST(ProcessExecutorTest, ReuseComputedResults) {
+    int* runs = sharedCounters(1);
+    TaskScheduler scheduler;
+
+    auto id1 = scheduler.add([runs] { return ++runs[0]; });
+    EXPECT_EQ(scheduler.getResult<int>(id1), 1);
+    auto id2 = scheduler.add([](int x) { return x + 1; }, scheduler.getFutureResult<int>(id1));
+
+    ProcessExecutor executor(scheduler, 2);
+    executor.executeAll();
+    EXPECT_NO_THROW(executor.executeAll());
+
+    EXPECT_EQ(scheduler.getResult<int>(id2), 2);
+    EXPECT_EQ(runs[0], 1);
+    munmap(runs, sizeof(int));
+}
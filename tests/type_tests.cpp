@@ -2,6 +2,7 @@
 #include "scheduler.h"
 #include <string>
 #include <memory>
+#include <vector>
 
 // Test support for different return types
 TEST(TaskSchedulerTest, MultipleTypes) {
@@ -71,4 +72,12 @@ TEST(TaskSchedulerTest, MoveOnlyTypeWithRef) {
     
     scheduler.executeAll();
     EXPECT_EQ(scheduler.getResult<int>(id), 6);
-}
\ No newline at end of file
+}
+
+// Test std::vector<bool> results
+TEST(TaskSchedulerTest, VectorBoolType) {
+    TaskScheduler scheduler;
+    auto id = scheduler.add([] { return std::vector<bool>{true, false}; });
+    scheduler.executeAll();
+    EXPECT_EQ(scheduler.getResult<std::vector<bool>>(id), (std::vector<bool>{true, false}));
+}